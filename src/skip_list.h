@@ -5,6 +5,7 @@
 #include <stddef.h>
 #include <stdint.h>
 #include <stdlib.h>
+#include <string.h>
 
 #include "bit_utils/bit_utils.h"
 
@@ -32,6 +33,12 @@ static inline size_t skip_list_random_level(rand_u32_gen_t *rng) {
 }
 #endif
 
+typedef enum {
+    SKIP_LIST_OP_INSERT,
+    SKIP_LIST_OP_DELETE,
+    SKIP_LIST_OP_DELETE_ALL
+} skip_list_op_t;
+
 #endif // SKIP_LIST_H
 
 #ifndef SKIP_LIST_NAME
@@ -50,6 +57,14 @@ static inline size_t skip_list_random_level(rand_u32_gen_t *rng) {
 #include <stdatomic.h>
 #endif
 
+/* In multimap mode, duplicate keys are allowed and kept in insertion order,
+ * so get, delete and replay always act on the oldest value for a key.
+ * The lock-free insert can't order concurrent inserts of equal keys.
+ */
+#if defined(SKIP_LIST_MULTIMAP) && defined(SKIP_LIST_THREAD_SAFE)
+#error "SKIP_LIST_MULTIMAP is not supported with SKIP_LIST_THREAD_SAFE"
+#endif
+
 #define SKIP_LIST_CONCAT_(a, b) a ## b
 #define SKIP_LIST_CONCAT(a, b) SKIP_LIST_CONCAT_(a, b)
 #define SKIP_LIST_TYPED(name) SKIP_LIST_CONCAT(SKIP_LIST_NAME, _##name)
@@ -121,6 +136,42 @@ typedef struct SKIP_LIST_HEAD {
 
 #define SKIP_LIST_NODE_MEMORY_POOL_FUNC(name) SKIP_LIST_CONCAT(SKIP_LIST_NODE_MEMORY_POOL_NAME, _##name)
 
+#define SKIP_LIST_CHANGE SKIP_LIST_TYPED(change_t)
+
+/* A single mutation, as recorded in the change log and consumed by replay.
+ * For deletes, value is the value that was removed. For delete_all, value is unused.
+ */
+typedef struct {
+    skip_list_op_t op;
+    SKIP_LIST_KEY_TYPE key;
+    SKIP_LIST_VALUE_TYPE value;
+} SKIP_LIST_CHANGE;
+
+#ifdef SKIP_LIST_CHANGE_LOG
+/* The change log is a fixed-size ring buffer of the most recent mutations
+ * which have not yet been drained. When it is full, new records are dropped
+ * and counted, and the consumer should fall back to a full sync.
+ */
+#ifndef SKIP_LIST_CHANGE_LOG_CAPACITY
+#define SKIP_LIST_CHANGE_LOG_CAPACITY 4096
+#endif
+
+#if (SKIP_LIST_CHANGE_LOG_CAPACITY & (SKIP_LIST_CHANGE_LOG_CAPACITY - 1)) != 0
+#error "SKIP_LIST_CHANGE_LOG_CAPACITY must be a power of 2"
+#endif
+
+#ifdef SKIP_LIST_THREAD_SAFE
+#define SKIP_LIST_CHANGE_LOG_SLOT SKIP_LIST_TYPED(change_log_slot_t)
+/* Each slot carries a sequence number so that producers and consumers can
+ * claim slots with a single CAS on the write/read position (bounded MPMC queue).
+ */
+typedef struct {
+    atomic_size_t sequence;
+    SKIP_LIST_CHANGE change;
+} SKIP_LIST_CHANGE_LOG_SLOT;
+#endif
+#endif
+
 typedef struct {
     #ifdef SKIP_LIST_THREAD_SAFE
     _Atomic(SKIP_LIST_HEAD) head;
@@ -137,6 +188,19 @@ typedef struct {
     size_t size;
     #endif
     SKIP_LIST_NODE_MEMORY_POOL_NAME *pool;
+    #ifdef SKIP_LIST_CHANGE_LOG
+    #ifdef SKIP_LIST_THREAD_SAFE
+    SKIP_LIST_CHANGE_LOG_SLOT *change_log;
+    atomic_size_t change_log_write;
+    atomic_size_t change_log_read;
+    atomic_size_t change_log_dropped;
+    #else
+    SKIP_LIST_CHANGE *change_log;
+    size_t change_log_write;
+    size_t change_log_read;
+    size_t change_log_dropped;
+    #endif
+    #endif
 } SKIP_LIST_NAME;
 
 SKIP_LIST_NAME *SKIP_LIST_FUNC(new_pool)(SKIP_LIST_NODE_MEMORY_POOL_NAME *pool) {
@@ -186,6 +250,34 @@ SKIP_LIST_NAME *SKIP_LIST_FUNC(new_pool)(SKIP_LIST_NODE_MEMORY_POOL_NAME *pool)
     list->size = 0;
     list->max_level = 0;
     #endif
+
+    #ifdef SKIP_LIST_CHANGE_LOG
+    #ifdef SKIP_LIST_THREAD_SAFE
+    list->change_log = malloc(SKIP_LIST_CHANGE_LOG_CAPACITY * sizeof(SKIP_LIST_CHANGE_LOG_SLOT));
+    if (list->change_log == NULL) {
+        tss_delete(list->random);
+        SKIP_LIST_NODE_MEMORY_POOL_FUNC(destroy)(list->pool);
+        free(list);
+        return NULL;
+    }
+    for (size_t i = 0; i < SKIP_LIST_CHANGE_LOG_CAPACITY; i++) {
+        atomic_init(&list->change_log[i].sequence, i);
+    }
+    atomic_init(&list->change_log_write, 0);
+    atomic_init(&list->change_log_read, 0);
+    atomic_init(&list->change_log_dropped, 0);
+    #else
+    list->change_log = malloc(SKIP_LIST_CHANGE_LOG_CAPACITY * sizeof(SKIP_LIST_CHANGE));
+    if (list->change_log == NULL) {
+        SKIP_LIST_NODE_MEMORY_POOL_FUNC(destroy)(list->pool);
+        free(list);
+        return NULL;
+    }
+    list->change_log_write = 0;
+    list->change_log_read = 0;
+    list->change_log_dropped = 0;
+    #endif
+    #endif
     return list;
 }
 
@@ -226,6 +318,106 @@ SKIP_LIST_NAME *SKIP_LIST_FUNC(new)(void) {
     return list;
 }
 
+#ifdef SKIP_LIST_CHANGE_LOG
+#define SKIP_LIST_CHANGE_LOG_MASK (SKIP_LIST_CHANGE_LOG_CAPACITY - 1)
+
+#ifdef SKIP_LIST_THREAD_SAFE
+static bool SKIP_LIST_FUNC(change_log_record)(SKIP_LIST_NAME *list, skip_list_op_t op, SKIP_LIST_KEY_TYPE key, SKIP_LIST_VALUE_TYPE value) {
+    size_t pos = atomic_load_explicit(&list->change_log_write, memory_order_relaxed);
+    SKIP_LIST_CHANGE_LOG_SLOT *slot;
+    for (;;) {
+        slot = &list->change_log[pos & SKIP_LIST_CHANGE_LOG_MASK];
+        size_t sequence = atomic_load_explicit(&slot->sequence, memory_order_acquire);
+        intptr_t diff = (intptr_t)sequence - (intptr_t)pos;
+        if (diff == 0) {
+            if (atomic_compare_exchange_weak_explicit(&list->change_log_write, &pos, pos + 1, memory_order_relaxed, memory_order_relaxed)) {
+                break;
+            }
+        } else if (diff < 0) {
+            // full, the consumer hasn't caught up
+            atomic_fetch_add_explicit(&list->change_log_dropped, 1, memory_order_relaxed);
+            return false;
+        } else {
+            pos = atomic_load_explicit(&list->change_log_write, memory_order_relaxed);
+        }
+    }
+    slot->change = (SKIP_LIST_CHANGE){
+        .op = op,
+        .key = key,
+        .value = value
+    };
+    atomic_store_explicit(&slot->sequence, pos + 1, memory_order_release);
+    return true;
+}
+
+/* Removes up to n of the oldest records from the change log, copying them
+ * in order into changes. Returns the number of records drained.
+ */
+size_t SKIP_LIST_FUNC(change_log_drain)(SKIP_LIST_NAME *list, SKIP_LIST_CHANGE *changes, size_t n) {
+    if (list == NULL || changes == NULL) return 0;
+    size_t drained = 0;
+    size_t pos = atomic_load_explicit(&list->change_log_read, memory_order_relaxed);
+    while (drained < n) {
+        SKIP_LIST_CHANGE_LOG_SLOT *slot = &list->change_log[pos & SKIP_LIST_CHANGE_LOG_MASK];
+        size_t sequence = atomic_load_explicit(&slot->sequence, memory_order_acquire);
+        intptr_t diff = (intptr_t)sequence - (intptr_t)(pos + 1);
+        if (diff == 0) {
+            if (atomic_compare_exchange_weak_explicit(&list->change_log_read, &pos, pos + 1, memory_order_relaxed, memory_order_relaxed)) {
+                changes[drained++] = slot->change;
+                atomic_store_explicit(&slot->sequence, pos + SKIP_LIST_CHANGE_LOG_CAPACITY, memory_order_release);
+                pos++;
+            }
+        } else if (diff < 0) {
+            // empty
+            break;
+        } else {
+            pos = atomic_load_explicit(&list->change_log_read, memory_order_relaxed);
+        }
+    }
+    return drained;
+}
+
+size_t SKIP_LIST_FUNC(change_log_dropped)(SKIP_LIST_NAME *list) {
+    if (list == NULL) return 0;
+    return atomic_load(&list->change_log_dropped);
+}
+#else
+static bool SKIP_LIST_FUNC(change_log_record)(SKIP_LIST_NAME *list, skip_list_op_t op, SKIP_LIST_KEY_TYPE key, SKIP_LIST_VALUE_TYPE value) {
+    if (list->change_log_write - list->change_log_read == SKIP_LIST_CHANGE_LOG_CAPACITY) {
+        // full, the consumer hasn't caught up
+        list->change_log_dropped++;
+        return false;
+    }
+    list->change_log[list->change_log_write & SKIP_LIST_CHANGE_LOG_MASK] = (SKIP_LIST_CHANGE){
+        .op = op,
+        .key = key,
+        .value = value
+    };
+    list->change_log_write++;
+    return true;
+}
+
+/* Removes up to n of the oldest records from the change log, copying them
+ * in order into changes. Returns the number of records drained.
+ */
+size_t SKIP_LIST_FUNC(change_log_drain)(SKIP_LIST_NAME *list, SKIP_LIST_CHANGE *changes, size_t n) {
+    if (list == NULL || changes == NULL) return 0;
+    size_t drained = 0;
+    while (drained < n && list->change_log_read != list->change_log_write) {
+        changes[drained++] = list->change_log[list->change_log_read & SKIP_LIST_CHANGE_LOG_MASK];
+        list->change_log_read++;
+    }
+    return drained;
+}
+
+size_t SKIP_LIST_FUNC(change_log_dropped)(SKIP_LIST_NAME *list) {
+    if (list == NULL) return 0;
+    return list->change_log_dropped;
+}
+#endif
+#undef SKIP_LIST_CHANGE_LOG_MASK
+#endif
+
 
 #ifdef SKIP_LIST_THREAD_SAFE
 
@@ -363,6 +555,21 @@ bool SKIP_LIST_FUNC(insert)(SKIP_LIST_NAME *list, SKIP_LIST_KEY_TYPE key, SKIP_L
     }
 
     atomic_fetch_add(&list->size, 1);
+    #ifdef SKIP_LIST_CHANGE_LOG
+    SKIP_LIST_FUNC(change_log_record)(list, SKIP_LIST_OP_INSERT, key, value);
+    #endif
+    return true;
+}
+
+/* Applies a batch of changes in order. The concurrent list only supports
+ * inserts, so replay stops and returns false at the first change it can't apply.
+ */
+bool SKIP_LIST_FUNC(replay)(SKIP_LIST_NAME *list, const SKIP_LIST_CHANGE *changes, size_t n) {
+    if (list == NULL) return false;
+    for (size_t i = 0; i < n; i++) {
+        if (changes[i].op != SKIP_LIST_OP_INSERT) return false;
+        if (!SKIP_LIST_FUNC(insert)(list, changes[i].key, changes[i].value)) return false;
+    }
     return true;
 }
 
@@ -374,7 +581,30 @@ size_t SKIP_LIST_FUNC(size)(SKIP_LIST_NAME *list) {
     return list->size;
 }
 
+/* Returns the first node on the bottom level with the given key, or NULL */
+static SKIP_LIST_NODE *SKIP_LIST_FUNC(find_first)(SKIP_LIST_NAME *list, SKIP_LIST_KEY_TYPE key) {
+    if (list == NULL || list->head == NULL || list->head->next == NULL) return NULL;
+    SKIP_LIST_NODE *current = list->head;
+    for (size_t level = list->max_level; level >= 1; level--) {
+        while (current->next != NULL && (SKIP_LIST_KEY_LESS_THAN(current->next->key, key))) {
+            current = current->next;
+        }
+        if (level >= 2) {
+            current = current->down;
+        }
+    }
+    if (current->next != NULL && SKIP_LIST_KEY_EQUALS(current->next->key, key)) {
+        return current->next;
+    }
+    return NULL;
+}
+
 void *SKIP_LIST_FUNC(get)(SKIP_LIST_NAME *list, SKIP_LIST_KEY_TYPE key) {
+    #ifdef SKIP_LIST_MULTIMAP
+    // oldest value for key
+    SKIP_LIST_NODE *first = SKIP_LIST_FUNC(find_first)(list, key);
+    return first != NULL ? (void *)first->down->next : NULL;
+    #else
     if (list == NULL || list->head == NULL || list->head->next == NULL) return NULL;
     bool beyond_placeholder = false;
     SKIP_LIST_NODE *current = list->head;
@@ -392,6 +622,29 @@ void *SKIP_LIST_FUNC(get)(SKIP_LIST_NAME *list, SKIP_LIST_KEY_TYPE key) {
         return (void *)current->next;
     }
     return NULL;
+    #endif
+}
+
+typedef void (*SKIP_LIST_TYPED(get_all_callback))(SKIP_LIST_VALUE_TYPE value, void *data);
+
+/* Calls callback for every value for key, in insertion order in multimap mode.
+ * Returns the number of values visited.
+ */
+size_t SKIP_LIST_FUNC(get_all)(SKIP_LIST_NAME *list, SKIP_LIST_KEY_TYPE key, SKIP_LIST_TYPED(get_all_callback) callback, void *data) {
+    size_t count = 0;
+    for (SKIP_LIST_NODE *node = SKIP_LIST_FUNC(find_first)(list, key);
+         node != NULL && SKIP_LIST_KEY_EQUALS(node->key, key);
+         node = node->next) {
+        if (callback != NULL) {
+            callback((SKIP_LIST_VALUE_TYPE)node->down->next, data);
+        }
+        count++;
+    }
+    return count;
+}
+
+size_t SKIP_LIST_FUNC(count)(SKIP_LIST_NAME *list, SKIP_LIST_KEY_TYPE key) {
+    return SKIP_LIST_FUNC(get_all)(list, key, NULL, NULL);
 }
 
 
@@ -430,7 +683,64 @@ void *SKIP_LIST_FUNC(get_next)(SKIP_LIST_NAME *list, SKIP_LIST_KEY_TYPE key) {
     return NULL;
 }
 
-bool SKIP_LIST_FUNC(insert)(SKIP_LIST_NAME *list, SKIP_LIST_KEY_TYPE key, SKIP_LIST_VALUE_TYPE value) {
+#define SKIP_LIST_FINGER SKIP_LIST_TYPED(finger_t)
+
+/* A search finger remembers, for each level, the rightmost node whose key
+ * was less than (or, for an upper search, equal to) the last key searched.
+ * A subsequent search for a key that is not less than the last one can resume
+ * from these nodes instead of the head, so a batch of operations in key order
+ * costs time proportional to the distance between consecutive keys rather than
+ * a full descent each time.
+ */
+typedef struct {
+    SKIP_LIST_NODE *preds[SKIP_LIST_MAX_LEVEL + 1];
+    SKIP_LIST_KEY_TYPE key;
+    bool upper;
+    // max_level of the list when preds were filled, 0 if the finger is unset
+    size_t max_level;
+    // preds above this level are head placeholders
+    size_t off_head_level;
+} SKIP_LIST_FINGER;
+
+static void SKIP_LIST_FUNC(find_preds)(SKIP_LIST_NAME *list, SKIP_LIST_KEY_TYPE key, bool upper, SKIP_LIST_FINGER *finger) {
+    /* Nodes are only ever unlinked when their key equals the key being deleted and
+     * head levels only change along with max_level, so as long as keys are
+     * non-decreasing and max_level is unchanged, the remembered preds are still
+     * linked and still precede key. Preds from an upper search may themselves
+     * have the same key, so they can't be reused for a lower search of that key.
+     */
+    bool resume = finger->max_level != 0 && finger->max_level == list->max_level && !SKIP_LIST_KEY_LESS_THAN(key, finger->key)
+                  && (upper || !finger->upper || SKIP_LIST_KEY_LESS_THAN(finger->key, key));
+    SKIP_LIST_NODE *current = list->head;
+    bool at_head = true;
+    size_t off_head_level = 0;
+    for (size_t level = list->max_level; level >= 1; level--) {
+        if (resume && level <= finger->off_head_level &&
+            (at_head || SKIP_LIST_KEY_LESS_THAN(current->key, finger->preds[level]->key))) {
+            current = finger->preds[level];
+            at_head = false;
+        }
+        while (current->next != NULL && (
+                SKIP_LIST_KEY_LESS_THAN(current->next->key, key)
+             || (upper && SKIP_LIST_KEY_EQUALS(current->next->key, key)))) {
+            current = current->next;
+            at_head = false;
+        }
+        finger->preds[level] = current;
+        if (!at_head && off_head_level == 0) {
+            off_head_level = level;
+        }
+        if (level >= 2) {
+            current = current->down;
+        }
+    }
+    finger->key = key;
+    finger->upper = upper;
+    finger->max_level = list->max_level;
+    finger->off_head_level = off_head_level;
+}
+
+static bool SKIP_LIST_FUNC(insert_finger)(SKIP_LIST_NAME *list, SKIP_LIST_KEY_TYPE key, SKIP_LIST_VALUE_TYPE value, SKIP_LIST_FINGER *finger) {
     SKIP_LIST_NODE *tmp_node = NULL;
     SKIP_LIST_NODE *new_node = SKIP_LIST_NODE_MEMORY_POOL_FUNC(get)(list->pool);
     if (new_node == NULL) return false;
@@ -469,67 +779,206 @@ bool SKIP_LIST_FUNC(insert)(SKIP_LIST_NAME *list, SKIP_LIST_KEY_TYPE key, SKIP_L
         list->max_level++;
     }
 
-    SKIP_LIST_NODE *current_node = list->head;
-    size_t current_level = list->max_level;
-    while (current_level >= 1) {
-        while (current_node->next != NULL && (
-                SKIP_LIST_KEY_LESS_THAN(current_node->next->key, key))) {
-            current_node = current_node->next;
-        }
-        if (current_level <= new_node_level) {
-            new_node->next = current_node->next;
-            current_node->next = new_node;
-            new_node = new_node->down;
-        }
-        if (current_level >= 2) {
-            current_node = current_node->down;
-        }
-        current_level--;
+    #ifdef SKIP_LIST_MULTIMAP
+    // insert after any existing values for key to keep them in insertion order
+    SKIP_LIST_FUNC(find_preds)(list, key, true, finger);
+    #else
+    SKIP_LIST_FUNC(find_preds)(list, key, false, finger);
+    #endif
+    for (size_t level = new_node_level; level >= 1; level--) {
+        new_node->next = finger->preds[level]->next;
+        finger->preds[level]->next = new_node;
+        new_node = new_node->down;
     }
     list->size++;
+    #ifdef SKIP_LIST_CHANGE_LOG
+    SKIP_LIST_FUNC(change_log_record)(list, SKIP_LIST_OP_INSERT, key, value);
+    #endif
     return true;
 }
 
-void *SKIP_LIST_FUNC(delete)(SKIP_LIST_NAME *list, SKIP_LIST_KEY_TYPE key) {
-    if (list == NULL || list->head == NULL) return NULL;
+static void SKIP_LIST_FUNC(remove_empty_levels)(SKIP_LIST_NAME *list) {
+    SKIP_LIST_NODE *tmp_node = NULL;
+    while (list->head->down != NULL && list->head->next == NULL) {
+        tmp_node = list->head->down;
+        list->head->down = tmp_node->down;
+        list->head->next = tmp_node->next;
+        list->max_level--;
+        SKIP_LIST_NODE_MEMORY_POOL_FUNC(release)(list->pool, tmp_node);
+    }
+}
+
+static void *SKIP_LIST_FUNC(delete_finger)(SKIP_LIST_NAME *list, SKIP_LIST_KEY_TYPE key, SKIP_LIST_FINGER *finger) {
     void *deleted = NULL;
-    SKIP_LIST_NODE *current_node = list->head;
+    bool found = false;
     SKIP_LIST_NODE *tmp_node = NULL;
-    while (current_node->down != NULL) {
-        while (current_node->next != NULL && (
-            SKIP_LIST_KEY_LESS_THAN(current_node->next->key, key))) {
-            current_node = current_node->next;
+    SKIP_LIST_NODE *lower = NULL;
+    SKIP_LIST_FUNC(find_preds)(list, key, false, finger);
+    /* Unlink the tower of the first node with this key on the bottom level. Since equal
+     * keys are in the same order on every level, it's also the first with this key on
+     * each level it reaches, which we can check by its down pointer.
+     */
+    for (size_t level = 1; level <= list->max_level; level++) {
+        SKIP_LIST_NODE *current_node = finger->preds[level];
+        tmp_node = current_node->next;
+        if (tmp_node == NULL || !SKIP_LIST_KEY_EQUALS(tmp_node->key, key) || (level > 1 && tmp_node->down != lower)) {
+            break;
         }
-        if (current_node->next != NULL && SKIP_LIST_KEY_EQUALS(current_node->next->key, key)) {
-            tmp_node = current_node->next;
-            // unlink node
+        // unlink node
+        current_node->next = tmp_node->next;
+        if (level == 1) {
+            // delete leaf
+            deleted = (void *)tmp_node->down->next;
+            SKIP_LIST_NODE_MEMORY_POOL_FUNC(release)(list->pool, tmp_node->down);
+            found = true;
+        } else {
+            SKIP_LIST_NODE_MEMORY_POOL_FUNC(release)(list->pool, lower);
+        }
+        lower = tmp_node;
+    }
+    if (lower != NULL) {
+        SKIP_LIST_NODE_MEMORY_POOL_FUNC(release)(list->pool, lower);
+    }
+    SKIP_LIST_FUNC(remove_empty_levels)(list);
+    if (found) {
+        list->size--;
+        #ifdef SKIP_LIST_CHANGE_LOG
+        SKIP_LIST_FUNC(change_log_record)(list, SKIP_LIST_OP_DELETE, key, (SKIP_LIST_VALUE_TYPE)deleted);
+        #endif
+    }
+    return deleted;
+}
+
+static size_t SKIP_LIST_FUNC(delete_all_finger)(SKIP_LIST_NAME *list, SKIP_LIST_KEY_TYPE key, SKIP_LIST_FINGER *finger) {
+    size_t deleted = 0;
+    SKIP_LIST_NODE *tmp_node = NULL;
+    SKIP_LIST_FUNC(find_preds)(list, key, false, finger);
+    for (size_t level = list->max_level; level >= 1; level--) {
+        SKIP_LIST_NODE *current_node = finger->preds[level];
+        // unlink the whole run of nodes with this key on this level
+        while ((tmp_node = current_node->next) != NULL && SKIP_LIST_KEY_EQUALS(tmp_node->key, key)) {
             current_node->next = tmp_node->next;
-            if (tmp_node->down->down == NULL) {
+            if (level == 1) {
                 // delete leaf
-                deleted = (void *)tmp_node->down->next;
                 SKIP_LIST_NODE_MEMORY_POOL_FUNC(release)(list->pool, tmp_node->down);
+                deleted++;
             }
             SKIP_LIST_NODE_MEMORY_POOL_FUNC(release)(list->pool, tmp_node);
         }
-        current_node = current_node->down;
     }
-    // remove empty levels in placeholder
-    while (list->head->down != NULL && list->head->next == NULL) {
-        tmp_node = list->head->down;
-        list->head->down = tmp_node->down;
-        list->head->next = tmp_node->next;
-        list->max_level--;
-        SKIP_LIST_NODE_MEMORY_POOL_FUNC(release)(list->pool, tmp_node);
+    SKIP_LIST_FUNC(remove_empty_levels)(list);
+    if (deleted > 0) {
+        list->size -= deleted;
+        #ifdef SKIP_LIST_CHANGE_LOG
+        SKIP_LIST_FUNC(change_log_record)(list, SKIP_LIST_OP_DELETE_ALL, key, (SKIP_LIST_VALUE_TYPE)NULL);
+        #endif
     }
-    list->size--;
     return deleted;
 }
+
+bool SKIP_LIST_FUNC(insert)(SKIP_LIST_NAME *list, SKIP_LIST_KEY_TYPE key, SKIP_LIST_VALUE_TYPE value) {
+    SKIP_LIST_FINGER finger = {.max_level = 0};
+    return SKIP_LIST_FUNC(insert_finger)(list, key, value, &finger);
+}
+
+void *SKIP_LIST_FUNC(delete)(SKIP_LIST_NAME *list, SKIP_LIST_KEY_TYPE key) {
+    if (list == NULL || list->head == NULL) return NULL;
+    SKIP_LIST_FINGER finger = {.max_level = 0};
+    return SKIP_LIST_FUNC(delete_finger)(list, key, &finger);
+}
+
+/* Removes every value for key, returning the number removed */
+size_t SKIP_LIST_FUNC(delete_all)(SKIP_LIST_NAME *list, SKIP_LIST_KEY_TYPE key) {
+    if (list == NULL || list->head == NULL) return 0;
+    SKIP_LIST_FINGER finger = {.max_level = 0};
+    return SKIP_LIST_FUNC(delete_all_finger)(list, key, &finger);
+}
+
+static bool SKIP_LIST_FUNC(changes_sorted)(const SKIP_LIST_CHANGE *changes, size_t n) {
+    for (size_t i = 1; i < n; i++) {
+        if (SKIP_LIST_KEY_LESS_THAN(changes[i].key, changes[i - 1].key)) return false;
+    }
+    return true;
+}
+
+/* Bottom-up merge sort by key. Stable, so changes to the same key keep their
+ * relative order. Returns whichever of the two buffers holds the sorted result.
+ */
+static SKIP_LIST_CHANGE *SKIP_LIST_FUNC(changes_sort)(SKIP_LIST_CHANGE *changes, SKIP_LIST_CHANGE *tmp, size_t n) {
+    SKIP_LIST_CHANGE *src = changes;
+    SKIP_LIST_CHANGE *dst = tmp;
+    for (size_t width = 1; width < n; width *= 2) {
+        for (size_t lo = 0; lo < n; lo += 2 * width) {
+            size_t mid = lo + width < n ? lo + width : n;
+            size_t hi = lo + 2 * width < n ? lo + 2 * width : n;
+            size_t i = lo, j = mid, k = lo;
+            while (i < mid && j < hi) {
+                if (SKIP_LIST_KEY_LESS_THAN(src[j].key, src[i].key)) {
+                    dst[k++] = src[j++];
+                } else {
+                    dst[k++] = src[i++];
+                }
+            }
+            while (i < mid) dst[k++] = src[i++];
+            while (j < hi) dst[k++] = src[j++];
+        }
+        SKIP_LIST_CHANGE *swap = src;
+        src = dst;
+        dst = swap;
+    }
+    return src;
+}
+
+/* Applies a batch of changes, e.g. drained from another list's change log.
+ * Changes to different keys commute, so the batch is stably sorted by key
+ * and applied with a search finger, making the cost proportional to the size
+ * of the batch rather than a full descent per change. Changes to the same key
+ * are applied in their original order. Returns false if an insert fails.
+ */
+bool SKIP_LIST_FUNC(replay)(SKIP_LIST_NAME *list, const SKIP_LIST_CHANGE *changes, size_t n) {
+    if (list == NULL) return false;
+    if (n == 0) return true;
+    if (changes == NULL) return false;
+
+    const SKIP_LIST_CHANGE *batch = changes;
+    SKIP_LIST_CHANGE *buffer = NULL;
+    if (!SKIP_LIST_FUNC(changes_sorted)(changes, n)) {
+        buffer = malloc(2 * n * sizeof(SKIP_LIST_CHANGE));
+        // without the buffer, apply in log order, which is still correct
+        if (buffer != NULL) {
+            memcpy(buffer, changes, n * sizeof(SKIP_LIST_CHANGE));
+            batch = SKIP_LIST_FUNC(changes_sort)(buffer, buffer + n, n);
+        }
+    }
+
+    bool success = true;
+    SKIP_LIST_FINGER finger = {.max_level = 0};
+    for (size_t i = 0; i < n; i++) {
+        if (batch[i].op == SKIP_LIST_OP_INSERT) {
+            if (!SKIP_LIST_FUNC(insert_finger)(list, batch[i].key, batch[i].value, &finger)) {
+                success = false;
+                break;
+            }
+        } else if (batch[i].op == SKIP_LIST_OP_DELETE) {
+            SKIP_LIST_FUNC(delete_finger)(list, batch[i].key, &finger);
+        } else if (batch[i].op == SKIP_LIST_OP_DELETE_ALL) {
+            SKIP_LIST_FUNC(delete_all_finger)(list, batch[i].key, &finger);
+        }
+    }
+    free(buffer);
+    return success;
+}
+
+#undef SKIP_LIST_FINGER
 #endif
 void SKIP_LIST_FUNC(destroy)(SKIP_LIST_NAME *list) {
     if (list == NULL) return;
     if (list->pool != NULL) {
         SKIP_LIST_NODE_MEMORY_POOL_FUNC(destroy)(list->pool);
     }
+    #ifdef SKIP_LIST_CHANGE_LOG
+    free(list->change_log);
+    #endif
     free(list);
 }
 
@@ -163,6 +163,229 @@ TEST test_skip_list_multithreaded(void) {
     PASS();
 }
 
+#define SKIP_LIST_NAME logged_skip_list_uint32
+#define SKIP_LIST_KEY_TYPE uint32_t
+#define SKIP_LIST_VALUE_TYPE char *
+#define SKIP_LIST_CHANGE_LOG
+#include "skip_list.h"
+#undef SKIP_LIST_NAME
+#undef SKIP_LIST_KEY_TYPE
+#undef SKIP_LIST_VALUE_TYPE
+#undef SKIP_LIST_CHANGE_LOG
+
+#define CHANGE_LOG_BATCH_SIZE 4
+
+TEST test_skip_list_change_log(void) {
+    logged_skip_list_uint32 *list = logged_skip_list_uint32_new();
+    logged_skip_list_uint32 *replica = logged_skip_list_uint32_new();
+
+    for (uint32_t i = 0; i < 26; i++) {
+        logged_skip_list_uint32_insert(list, (i * 7) % 26, alphabet[(i * 7) % 26]);
+    }
+    for (uint32_t i = 0; i < 26; i += 3) {
+        logged_skip_list_uint32_delete(list, i);
+    }
+    // deleting a missing key is not a change
+    char *missing = logged_skip_list_uint32_delete(list, 100);
+    ASSERT(missing == NULL);
+    ASSERT_EQ(logged_skip_list_uint32_size(list), 17);
+
+    logged_skip_list_uint32_change_t changes[CHANGE_LOG_BATCH_SIZE];
+    size_t num_changes = 0;
+    size_t n;
+    while ((n = logged_skip_list_uint32_change_log_drain(list, changes, CHANGE_LOG_BATCH_SIZE)) > 0) {
+        ASSERT(logged_skip_list_uint32_replay(replica, changes, n));
+        num_changes += n;
+    }
+    ASSERT_EQ(num_changes, 26 + 9);
+    ASSERT_EQ(logged_skip_list_uint32_change_log_dropped(list), 0);
+
+    ASSERT_EQ(logged_skip_list_uint32_size(replica), 17);
+    for (uint32_t i = 0; i < 26; i++) {
+        char *value = logged_skip_list_uint32_get(replica, i);
+        if (i % 3 == 0) {
+            ASSERT(value == NULL);
+        } else {
+            ASSERT_STR_EQ(alphabet[i], value);
+        }
+    }
+
+    // an unsorted batch with repeated keys is applied in log order per key
+    logged_skip_list_uint32_change_t batch[] = {
+        {.op = SKIP_LIST_OP_DELETE, .key = 25},
+        {.op = SKIP_LIST_OP_INSERT, .key = 0, .value = "a"},
+        {.op = SKIP_LIST_OP_INSERT, .key = 25, .value = "z"},
+        {.op = SKIP_LIST_OP_DELETE, .key = 1},
+        {.op = SKIP_LIST_OP_DELETE, .key = 0},
+        {.op = SKIP_LIST_OP_INSERT, .key = 3, .value = "d"},
+    };
+    ASSERT(logged_skip_list_uint32_replay(replica, batch, sizeof(batch) / sizeof(batch[0])));
+    ASSERT_EQ(logged_skip_list_uint32_size(replica), 17);
+    ASSERT(logged_skip_list_uint32_get(replica, 0) == NULL);
+    ASSERT(logged_skip_list_uint32_get(replica, 1) == NULL);
+    ASSERT_STR_EQ("d", logged_skip_list_uint32_get(replica, 3));
+    ASSERT_STR_EQ("z", logged_skip_list_uint32_get(replica, 25));
+
+    // records beyond the capacity of the log are dropped and counted
+    while (logged_skip_list_uint32_change_log_drain(list, changes, CHANGE_LOG_BATCH_SIZE) > 0);
+    for (uint32_t i = 0; i < SKIP_LIST_CHANGE_LOG_CAPACITY + 10; i++) {
+        logged_skip_list_uint32_insert(list, 1000 + i, "x");
+    }
+    ASSERT_EQ(logged_skip_list_uint32_change_log_dropped(list), 10);
+
+    logged_skip_list_uint32_destroy(list);
+    logged_skip_list_uint32_destroy(replica);
+    PASS();
+}
+
+#define SKIP_LIST_NAME concurrent_logged_skip_list_uint32
+#define SKIP_LIST_KEY_TYPE uint32_t
+#define SKIP_LIST_VALUE_TYPE char *
+#define SKIP_LIST_THREAD_SAFE
+#define SKIP_LIST_CHANGE_LOG
+#include "skip_list.h"
+#undef SKIP_LIST_NAME
+#undef SKIP_LIST_KEY_TYPE
+#undef SKIP_LIST_VALUE_TYPE
+#undef SKIP_LIST_THREAD_SAFE
+#undef SKIP_LIST_CHANGE_LOG
+
+#define NUM_LOGGED_INSERTS 500
+
+struct logged_thread_args {
+    concurrent_logged_skip_list_uint32 *list;
+    uint32_t multiplier;
+};
+
+int test_skip_list_change_log_thread(void *arg) {
+    struct logged_thread_args *args = (struct logged_thread_args *)arg;
+    for (uint32_t i = args->multiplier; i < NUM_THREADS * NUM_LOGGED_INSERTS; i += NUM_THREADS) {
+        concurrent_logged_skip_list_uint32_insert(args->list, i, alphabet[i % 26]);
+    }
+    return 0;
+}
+
+TEST test_skip_list_change_log_multithreaded(void) {
+    concurrent_logged_skip_list_uint32 *list = concurrent_logged_skip_list_uint32_new();
+    struct logged_thread_args args[NUM_THREADS];
+    thrd_t threads[NUM_THREADS];
+    for (uint32_t i = 0; i < NUM_THREADS; i++) {
+        args[i].list = list;
+        args[i].multiplier = i;
+        thrd_create(&threads[i], test_skip_list_change_log_thread, &args[i]);
+    }
+    for (uint32_t i = 0; i < NUM_THREADS; i++) {
+        thrd_join(threads[i], NULL);
+    }
+    ASSERT_EQ(concurrent_logged_skip_list_uint32_change_log_dropped(list), 0);
+
+    concurrent_logged_skip_list_uint32 *replica = concurrent_logged_skip_list_uint32_new();
+    concurrent_logged_skip_list_uint32_change_t changes[CHANGE_LOG_BATCH_SIZE];
+    size_t num_changes = 0;
+    size_t n;
+    while ((n = concurrent_logged_skip_list_uint32_change_log_drain(list, changes, CHANGE_LOG_BATCH_SIZE)) > 0) {
+        ASSERT(concurrent_logged_skip_list_uint32_replay(replica, changes, n));
+        num_changes += n;
+    }
+    ASSERT_EQ(num_changes, NUM_THREADS * NUM_LOGGED_INSERTS);
+    ASSERT_EQ(concurrent_logged_skip_list_uint32_size(replica), NUM_THREADS * NUM_LOGGED_INSERTS);
+    for (uint32_t i = 0; i < NUM_THREADS * NUM_LOGGED_INSERTS; i++) {
+        char *value = concurrent_logged_skip_list_uint32_get(replica, i);
+        ASSERT(value != NULL);
+        ASSERT_STR_EQ(alphabet[i % 26], value);
+    }
+
+    concurrent_logged_skip_list_uint32_destroy(list);
+    concurrent_logged_skip_list_uint32_destroy(replica);
+    PASS();
+}
+
+#define SKIP_LIST_NAME multimap_uint32
+#define SKIP_LIST_KEY_TYPE uint32_t
+#define SKIP_LIST_VALUE_TYPE char *
+#define SKIP_LIST_MULTIMAP
+#define SKIP_LIST_CHANGE_LOG
+#include "skip_list.h"
+#undef SKIP_LIST_NAME
+#undef SKIP_LIST_KEY_TYPE
+#undef SKIP_LIST_VALUE_TYPE
+#undef SKIP_LIST_MULTIMAP
+#undef SKIP_LIST_CHANGE_LOG
+
+struct multimap_values {
+    char *values[26];
+    size_t num_values;
+};
+
+void multimap_collect(char *value, void *data) {
+    struct multimap_values *collected = (struct multimap_values *)data;
+    collected->values[collected->num_values++] = value;
+}
+
+TEST test_skip_list_multimap(void) {
+    multimap_uint32 *list = multimap_uint32_new();
+    multimap_uint32 *replica = multimap_uint32_new();
+
+    // interleave several runs of equal keys
+    for (uint32_t i = 0; i < 26; i++) {
+        multimap_uint32_insert(list, i % 3, alphabet[i]);
+    }
+    multimap_uint32_insert(list, 10, "x");
+    ASSERT_EQ(multimap_uint32_size(list), 27);
+    ASSERT_EQ(multimap_uint32_count(list, 1), 9);
+    ASSERT_EQ(multimap_uint32_count(list, 2), 8);
+    ASSERT_EQ(multimap_uint32_count(list, 5), 0);
+
+    // oldest value first, then insertion order
+    ASSERT_STR_EQ("b", multimap_uint32_get(list, 1));
+    struct multimap_values collected = {.num_values = 0};
+    ASSERT_EQ(multimap_uint32_get_all(list, 1, multimap_collect, &collected), 9);
+    ASSERT_EQ(collected.num_values, 9);
+    for (size_t i = 0; i < collected.num_values; i++) {
+        ASSERT_STR_EQ(alphabet[3 * i + 1], collected.values[i]);
+    }
+
+    ASSERT_STR_EQ("x", multimap_uint32_get_next(list, 2));
+
+    char *b = multimap_uint32_delete(list, 1);
+    ASSERT_STR_EQ("b", b);
+    ASSERT_STR_EQ("e", multimap_uint32_get(list, 1));
+    ASSERT_EQ(multimap_uint32_count(list, 1), 8);
+    ASSERT_EQ(multimap_uint32_size(list), 26);
+
+    ASSERT_EQ(multimap_uint32_delete_all(list, 0), 9);
+    ASSERT_EQ(multimap_uint32_count(list, 0), 0);
+    ASSERT(multimap_uint32_get(list, 0) == NULL);
+    ASSERT_EQ(multimap_uint32_delete_all(list, 0), 0);
+    ASSERT_EQ(multimap_uint32_size(list), 17);
+    ASSERT_EQ(multimap_uint32_count(list, 1), 8);
+    ASSERT_EQ(multimap_uint32_count(list, 2), 8);
+
+    // replaying the log reproduces the same runs in the same order
+    multimap_uint32_change_t changes[CHANGE_LOG_BATCH_SIZE];
+    size_t n;
+    while ((n = multimap_uint32_change_log_drain(list, changes, CHANGE_LOG_BATCH_SIZE)) > 0) {
+        ASSERT(multimap_uint32_replay(replica, changes, n));
+    }
+    ASSERT_EQ(multimap_uint32_size(replica), 17);
+    ASSERT_EQ(multimap_uint32_count(replica, 0), 0);
+    collected.num_values = 0;
+    ASSERT_EQ(multimap_uint32_get_all(replica, 1, multimap_collect, &collected), 8);
+    for (size_t i = 0; i < collected.num_values; i++) {
+        ASSERT_STR_EQ(alphabet[3 * (i + 1) + 1], collected.values[i]);
+    }
+
+    ASSERT_EQ(multimap_uint32_delete_all(list, 1), 8);
+    ASSERT_EQ(multimap_uint32_delete_all(list, 2), 8);
+    ASSERT_STR_EQ("x", multimap_uint32_delete(list, 10));
+    ASSERT_EQ(multimap_uint32_size(list), 0);
+    ASSERT(multimap_uint32_get(list, 10) == NULL);
+
+    multimap_uint32_destroy(list);
+    multimap_uint32_destroy(replica);
+    PASS();
+}
+
 /* Add definitions that need to be in the test runner's main file. */
 GREATEST_MAIN_DEFS();
 
@@ -171,6 +394,9 @@ int main(int argc, char **argv) {
 
     RUN_TEST(test_skip_list);
     RUN_TEST(test_skip_list_multithreaded);
+    RUN_TEST(test_skip_list_change_log);
+    RUN_TEST(test_skip_list_change_log_multithreaded);
+    RUN_TEST(test_skip_list_multimap);
 
     GREATEST_MAIN_END();        /* display results */
 }
\ No newline at end of file